@@ -7,8 +7,10 @@ ClientSession::ClientSession(asio::ip::tcp::socket socket, Game::GameServer& ser
     : m_socket(std::move(socket)), m_server(server) {}
 
 void ClientSession::Start() {
+    m_lastActivity = Game::TimerWheel::Clock::now().time_since_epoch().count();
     // 会话开始时，立即启动第一次异步读取
     DoRead();
+    ScheduleHeartbeat();
 }
 
 void ClientSession::SendMessage(const std::string& message) {
@@ -34,6 +36,9 @@ void ClientSession::DoRead() {
 
 void ClientSession::OnRead(const asio::error_code& ec, size_t bytes_transferred) {
     if (!ec) {
+        // 任何来自客户端的数据都视为活跃，心跳检查时会据此判断是否空闲
+        m_lastActivity = Game::TimerWheel::Clock::now().time_since_epoch().count();
+
         // 从缓冲区中提取一行数据
         std::istream is(&m_readBuffer);
         std::string message(bytes_transferred, '\0');
@@ -58,7 +63,9 @@ void ClientSession::HandleMessage(const std::string& message) {
         auto json_msg = nlohmann::json::parse(message);
         std::string type = json_msg.value("type", "");
 
-        if (type == "CONNECT" && json_msg.contains("playerName")) {
+        if (type == "PONG") {
+            // 心跳回应，活跃时间已在 OnRead 中更新
+        } else if (type == "CONNECT" && json_msg.contains("playerName")) {
             m_server.HandleClientConnect(shared_from_this(), json_msg["playerName"]);
         } else if (m_playerId != -1) { // 确保已分配ID
             if (type == "PLAYER_UPDATE") {
@@ -95,7 +102,44 @@ void ClientSession::OnWrite(const asio::error_code& ec, size_t /*bytes_transferr
     }
 }
 
+void ClientSession::ScheduleHeartbeat() {
+    // 时间轮只持有 weak_ptr，不会延长会话的生命周期
+    std::weak_ptr<ClientSession> weak = shared_from_this();
+    m_heartbeatTimerId = m_server.GetTimerWheel().Schedule(HEARTBEAT_INTERVAL, [weak]() {
+        if (auto self = weak.lock()) {
+            // 时间轮回调运行在驱动线程上，投递到会话的 strand 中，与读写处理串行执行
+            asio::post(self->m_socket.get_executor(), [self]() { self->OnHeartbeat(); });
+        }
+    });
+    // 如果 Close() 在登记期间执行，它取消的是旧的ID，这里负责取消新登记的定时器
+    if (m_closed) {
+        m_server.GetTimerWheel().Cancel(m_heartbeatTimerId);
+    }
+}
+
+void ClientSession::OnHeartbeat() {
+    if (m_closed) return;
+
+    auto lastActivity = Game::TimerWheel::Clock::time_point(Game::TimerWheel::Clock::duration(m_lastActivity.load()));
+    auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(Game::TimerWheel::Clock::now() - lastActivity);
+
+    if (idle >= IDLE_TIMEOUT) {
+        spdlog::warn("Client {} idle for {} ms, closing connection.", m_playerId, idle.count());
+        Close();
+        return;
+    }
+
+    if (idle >= HEARTBEAT_INTERVAL) {
+        nlohmann::json pingMsg = {{"type", "PING"}};
+        SendMessage(pingMsg.dump());
+    }
+    ScheduleHeartbeat();
+}
+
 void ClientSession::Close() {
+    if (m_closed.exchange(true)) return;
+    m_server.GetTimerWheel().Cancel(m_heartbeatTimerId);
+
     // 从服务器中移除此客户端
     m_server.RemoveClient(shared_from_this());
     // 关闭socket，这将取消所有挂起的异步操作
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <asio.hpp>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <deque>
 #include <string>
+#include "TimerWheel.h"
 
 namespace Game { class GameServer; } // 前向声明
 
@@ -41,10 +44,22 @@ private:
     // 关闭连接
     void Close();
 
+    // 心跳检测：在共享时间轮上登记下一次检查
+    void ScheduleHeartbeat();
+    // 心跳检查到期：空闲过久则断开，否则按需发送 PING
+    void OnHeartbeat();
+
 private:
+    // 超过 HEARTBEAT_INTERVAL 没有收到任何数据就发送 PING，超过 IDLE_TIMEOUT 则认为连接已失效
+    static constexpr std::chrono::milliseconds HEARTBEAT_INTERVAL{5000};
+    static constexpr std::chrono::milliseconds IDLE_TIMEOUT{15000};
+
     asio::ip::tcp::socket m_socket;     // 此会话的socket
     Game::GameServer& m_server;         // GameServer的引用
     asio::streambuf m_readBuffer;       // 用于读取数据的缓冲区
     std::deque<std::string> m_writeQueue; // 待发送消息的队列
     int m_playerId = -1;                // 玩家ID，-1表示尚未分配
+    std::atomic<bool> m_closed{false};  // 防止重复关闭
+    std::atomic<Game::TimerWheel::Clock::rep> m_lastActivity{0}; // 最后一次收到数据的时间
+    std::atomic<Game::TimerWheel::TimerId> m_heartbeatTimerId{Game::TimerWheel::INVALID_TIMER_ID};
 };
\ No newline at end of file
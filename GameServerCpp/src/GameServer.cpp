@@ -2,9 +2,27 @@
 #include "ClientSession.h"
 #include <spdlog/spdlog.h>
 #include <random>
+#include <cmath>
+#include <charconv>
 
 namespace Game {
 
+namespace {
+
+// 直接将浮点数格式化到 out 中，避免为每个坐标构造临时的 json 对象和字符串
+// std::to_chars 输出能精确还原该 float 的最短表示；与 nlohmann 一致，非有限值输出 null
+void AppendFloat(std::string& out, float value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+} // namespace
+
 // 单例实例的实现
 GameServer& GameServer::Instance() {
     static GameServer instance;
@@ -16,7 +34,8 @@ GameServer::GameServer()
     : m_acceptor(m_ioContext),
       m_signals(m_ioContext, SIGINT, SIGTERM),
       m_broadcastTimer(m_ioContext),
-      m_gameCountdownTimer(m_ioContext)
+      m_gameCountdownTimer(m_ioContext),
+      m_timerWheelTimer(m_ioContext)
 {
     // 设置信号处理，用于优雅关闭服务器
     m_signals.async_wait([this](const asio::error_code&, int) {
@@ -44,6 +63,7 @@ void GameServer::Start(unsigned short port) {
     m_acceptor.listen();
 
     DoAccept(); // 开始接受连接
+    StartTimerWheel(); // 开始驱动会话心跳检测
 
     // 创建线程池来运行 io_context，充分利用多核CPU
     // 通常线程数等于硬件并发线程数
@@ -65,6 +85,7 @@ void GameServer::Stop() {
         
         m_broadcastTimer.cancel();
         m_gameCountdownTimer.cancel();
+        m_timerWheelTimer.cancel();
         m_acceptor.close();
         
         m_ioContext.stop();
@@ -81,7 +102,8 @@ void GameServer::Stop() {
 
 void GameServer::DoAccept() {
     // 异步接受新连接
-    m_acceptor.async_accept([this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+    // 每个 socket 绑定到独立的 strand 上，使同一会话的所有处理函数（读、写、心跳）串行执行
+    m_acceptor.async_accept(asio::make_strand(m_ioContext), [this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
         if (!ec) {
             spdlog::info("New client connected from: {}", socket.remote_endpoint().address().to_string());
             // 使用 std::make_shared 创建 ClientSession，并启动它
@@ -96,6 +118,24 @@ void GameServer::DoAccept() {
     });
 }
 
+void GameServer::StartTimerWheel() {
+    m_timerWheelTimer.expires_at(std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMER_WHEEL_TICK_MS));
+    m_timerWheelTimer.async_wait([this](const asio::error_code& ec){ this->OnTimerWheelTick(ec); });
+}
+
+void GameServer::OnTimerWheelTick(const asio::error_code& ec) {
+    if (ec) {
+        if (ec != asio::error::operation_aborted) spdlog::error("Timer wheel error: {}", ec.message());
+        return;
+    }
+
+    // 时间轮按实际时间推进，即使本次回调被延迟也不会丢失 tick
+    m_timerWheel.Advance(std::chrono::steady_clock::now());
+
+    m_timerWheelTimer.expires_at(m_timerWheelTimer.expiry() + std::chrono::milliseconds(TIMER_WHEEL_TICK_MS));
+    m_timerWheelTimer.async_wait([this](const asio::error_code& ec){ this->OnTimerWheelTick(ec); });
+}
+
 // 处理新客户端连接请求
 void GameServer::HandleClientConnect(std::shared_ptr<ClientSession> session, const std::string& playerName) {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -116,15 +156,14 @@ void GameServer::HandleClientConnect(std::shared_ptr<ClientSession> session, con
     // 创建新玩家数据
     PlayerData newPlayer(playerId, playerName, SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f, playerColor);
     m_players[playerId] = newPlayer;
+    m_playerStaticJson[playerId] = EncodePlayerStaticFields(newPlayer);
     m_clients[playerId] = session;
 
     // 发送欢迎消息，包含初始游戏状态
-    nlohmann::json welcomeMsg = {
-        {"type", "WELCOME"},
-        {"playerId", playerId},
-        {"initialGameState", GetCurrentGameStateJson()}
-    };
-    session->SendMessage(welcomeMsg.dump());
+    std::string welcomeMsg = R"({"type":"WELCOME","playerId":)" + std::to_string(playerId) + R"(,"initialGameState":{)";
+    AppendGameStateFields(welcomeMsg);
+    welcomeMsg += "}}";
+    session->SendMessage(welcomeMsg);
 
     // 向其他玩家广播新玩家加入的消息
     nlohmann::json playerJoinedMsg = {
@@ -148,6 +187,7 @@ void GameServer::RemoveClient(std::shared_ptr<ClientSession> session) {
 
     if (m_clients.erase(playerId) > 0) {
         m_players.erase(playerId);
+        m_playerStaticJson.erase(playerId);
         
         nlohmann::json playerLeftMsg = {
             {"type", "PLAYER_LEFT"},
@@ -213,6 +253,7 @@ void GameServer::HandlePlayerAteFood(int playerId, int foodId) {
             // 从列表中移除食物
             FoodData eatenFood = *food_it;
             m_foods.erase(food_it);
+            m_foodJson.erase(eatenFood.id);
 
             player.score += 10;
             spdlog::info("Player {} ate food {}. New score: {}", playerId, foodId, player.score);
@@ -246,13 +287,12 @@ void GameServer::SpawnNewFood(bool broadcast) {
         newFood.y = static_cast<float>(y_dist(gen));
         
         m_foods.push_back(newFood);
+        // 食物生成后直到被吃掉都不会改变，在这里一次性序列化
+        const std::string& foodJson = m_foodJson[newFood.id] = nlohmann::json(newFood).dump();
 
         if (broadcast) {
-            nlohmann::json foodSpawnedMsg = {
-                {"type", "FOOD_SPAWNED"},
-                {"food", newFood}
-            };
-            BroadcastMessage(foodSpawnedMsg.dump());
+            std::string foodSpawnedMsg = R"({"type":"FOOD_SPAWNED","food":)" + foodJson + "}";
+            BroadcastMessage(foodSpawnedMsg);
         }
     }
 }
@@ -260,16 +300,43 @@ void GameServer::SpawnNewFood(bool broadcast) {
 
 // --- 游戏流程控制 ---
 
-nlohmann::json GameServer::GetCurrentGameStateJson() {
+std::string GameServer::EncodePlayerStaticFields(const PlayerData& player) {
+    // 只包含加入后不再改变的字段，去掉外层花括号以便与 x/y/score 拼接
+    std::string object = nlohmann::json{{"id", player.id}, {"name", player.name}, {"colorHex", player.colorHex}}.dump();
+    return object.substr(1, object.size() - 2);
+}
+
+void GameServer::AppendGameStateFields(std::string& out) {
     // 注意：这个函数应该在持有锁的情况下被调用
-    nlohmann::json state;
-    state["timer"] = m_remainingTimeSeconds.load();
-    state["players"] = nlohmann::json::array();
-    for(const auto& pair : m_players) {
-        state["players"].push_back(pair.second);
+    // 缓存必须与实体同时存在，使用 at() 查找：缺失时抛出异常，而不是插入空片段生成错误的JSON
+    out += R"("timer":)";
+    out += std::to_string(m_remainingTimeSeconds.load());
+
+    out += R"(,"players":[)";
+    bool first = true;
+    for (const auto& pair : m_players) {
+        const PlayerData& player = pair.second;
+        if (!first) out += ',';
+        first = false;
+        out += '{';
+        out += m_playerStaticJson.at(player.id);
+        out += R"(,"x":)";
+        AppendFloat(out, player.x);
+        out += R"(,"y":)";
+        AppendFloat(out, player.y);
+        out += R"(,"score":)";
+        out += std::to_string(player.score);
+        out += '}';
+    }
+
+    out += R"(],"foods":[)";
+    first = true;
+    for (const auto& food : m_foods) {
+        if (!first) out += ',';
+        first = false;
+        out += m_foodJson.at(food.id);
     }
-    state["foods"] = m_foods;
-    return state;
+    out += ']';
 }
 
 void GameServer::StartGame() {
@@ -287,6 +354,7 @@ void GameServer::StartGame() {
         pair.second.score = 0;
     }
     m_foods.clear();
+    m_foodJson.clear();
     for (int i = 0; i < MAX_FOODS_ON_SCREEN; ++i) {
         SpawnNewFood(false);
     }
@@ -365,13 +433,16 @@ void GameServer::BroadcastGameState(const asio::error_code& ec) {
         return;
     }
 
-    nlohmann::json stateUpdate;
+    std::string stateUpdate;
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        stateUpdate["type"] = "GAME_STATE_UPDATE";
-        stateUpdate.update(GetCurrentGameStateJson());
+        stateUpdate.reserve(m_lastSnapshotSize);
+        stateUpdate += R"({"type":"GAME_STATE_UPDATE",)";
+        AppendGameStateFields(stateUpdate);
+        stateUpdate += '}';
+        m_lastSnapshotSize = stateUpdate.size();
     }
-    BroadcastMessage(stateUpdate.dump());
+    BroadcastMessage(stateUpdate);
 
     // 重新设置广播定时器
     m_broadcastTimer.expires_at(m_broadcastTimer.expiry() + std::chrono::milliseconds(BROADCAST_INTERVAL_MS));
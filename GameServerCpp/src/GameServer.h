@@ -9,6 +9,7 @@
 //#include <recursive_mutex>
 #include <atomic>
 #include "DataTypes.h"
+#include "TimerWheel.h"
 
 // 前向声明，避免在头文件中包含 ClientSession.h，减少编译依赖
 class ClientSession;
@@ -40,6 +41,9 @@ public:
     // 向所有客户端广播消息，可选择排除一个
     void BroadcastMessage(const std::string& message, std::shared_ptr<ClientSession> exclude_session = nullptr);
 
+    // 所有会话共用的时间轮，用于心跳和空闲超时检测
+    TimerWheel& GetTimerWheel() { return m_timerWheel; }
+
 private:
     // 私有构造函数，防止外部直接创建实例
     GameServer();
@@ -49,6 +53,8 @@ private:
     // --- 内部异步操作 ---
     void DoAccept(); // 开始接受新的客户端连接
     void OnAccept(const asio::error_code& ec, asio::ip::tcp::socket socket); // 接受连接后的回调
+    void StartTimerWheel(); // 启动驱动时间轮的定时器
+    void OnTimerWheelTick(const asio::error_code& ec);
 
     // --- 游戏逻辑与定时器 ---
     void StartGame();
@@ -56,7 +62,10 @@ private:
     void UpdateGameTimer(const asio::error_code& ec);
     void BroadcastGameState(const asio::error_code& ec);
     void SpawnNewFood(bool broadcast);
-    nlohmann::json GetCurrentGameStateJson();
+    // 将当前游戏状态的字段 (timer, players, foods) 追加到 out，不含外层花括号
+    // 静态字段和食物使用缓存的JSON片段直接拼接，避免每次广播都重建 json DOM
+    void AppendGameStateFields(std::string& out);
+    static std::string EncodePlayerStaticFields(const PlayerData& player);
 
 private:
     // --- 常量配置 ---
@@ -67,6 +76,7 @@ private:
     static constexpr int MAX_FOODS_ON_SCREEN = 50;
     static constexpr float PLAYER_RADIUS = 30.0f;
     static constexpr long BROADCAST_INTERVAL_MS = 50;
+    static constexpr long TIMER_WHEEL_TICK_MS = 100;
 
     // --- Asio 核心组件 ---
     asio::io_context m_ioContext; // 异步I/O事件循环
@@ -74,6 +84,8 @@ private:
     asio::signal_set m_signals; // 处理系统信号，用于优雅停机
     asio::steady_timer m_broadcastTimer; // 定时广播游戏状态
     asio::steady_timer m_gameCountdownTimer; // 游戏倒计时
+    asio::steady_timer m_timerWheelTimer; // 驱动时间轮的唯一定时器
+    TimerWheel m_timerWheel{std::chrono::milliseconds(TIMER_WHEEL_TICK_MS)}; // 会话心跳/空闲检测
     std::vector<std::thread> m_threadPool; // 线程池来运行 io_context
 
     // --- 游戏状态 (线程安全) ---
@@ -83,6 +95,12 @@ private:
     std::unordered_map<int, PlayerData> m_players;
     std::vector<FoodData> m_foods;
 
+    // 快照用的JSON片段缓存，与实体同时创建、同时删除
+    // 玩家的 id/name/colorHex 和食物的全部字段在实体存在期间都不会被修改，因此缓存不会过期
+    std::unordered_map<int, std::string> m_playerStaticJson; // 玩家ID -> 静态字段片段（不含花括号）
+    std::unordered_map<int, std::string> m_foodJson;         // 食物ID -> 完整的JSON对象
+    size_t m_lastSnapshotSize = 0; // 上一次快照的长度，用于预分配缓冲区
+
     std::atomic<int> m_nextPlayerId{0};
     std::atomic<int> m_nextFoodId{0};
     
@@ -0,0 +1,101 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace Game {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tickInterval)
+    : m_tickInterval(std::max(tickInterval, std::chrono::milliseconds(1))),
+      m_startTime(Clock::now()) {}
+
+TimerWheel::TimerId TimerWheel::Schedule(std::chrono::milliseconds delay, Callback callback) {
+    // 到期时间按实际时间计算并向上取整到 tick：m_currentTick 可能落后实际时间将近一个 tick，
+    // 以它为基准会导致定时器提前触发
+    auto deadline = (Clock::now() - m_startTime) + std::max(delay, std::chrono::milliseconds(0));
+    auto tick = std::chrono::duration_cast<Clock::duration>(m_tickInterval);
+    auto deadlineTick = static_cast<std::uint64_t>((deadline + tick - Clock::duration(1)) / tick);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TimerId id = m_nextId++;
+    // 至少延迟一个 tick，保证不会在本轮 Advance 中立即触发
+    std::uint64_t expireTick = std::max(deadlineTick, m_currentTick + 1);
+    m_entries.emplace(id, Entry{expireTick, std::move(callback)});
+    Place(id, expireTick);
+    return id;
+}
+
+void TimerWheel::Cancel(TimerId id) {
+    if (id == INVALID_TIMER_ID) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(id);
+}
+
+void TimerWheel::Advance(Clock::time_point now) {
+    if (now < m_startTime) return;
+    auto targetTick = static_cast<std::uint64_t>((now - m_startTime) / m_tickInterval);
+
+    std::vector<Callback> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 驱动定时器如果被延迟，这里会一次补上所有落下的 tick
+        while (m_currentTick < targetTick) {
+            Tick(expired);
+        }
+    }
+
+    for (auto& callback : expired) {
+        callback();
+    }
+}
+
+void TimerWheel::Place(TimerId id, std::uint64_t expireTick) {
+    // 超出时间轮范围的定时器先放在最高层最远的槽位，cascade 时再按真实到期时间重新分配
+    std::uint64_t delta = expireTick > m_currentTick ? expireTick - m_currentTick : 0;
+    delta = std::min(delta, MAX_TICKS);
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ull << (LEVEL_BITS * (level + 1)))) {
+        ++level;
+    }
+    std::uint64_t slot = ((m_currentTick + delta) >> (LEVEL_BITS * level)) & SLOT_MASK;
+    m_slots[level][slot].push_back(id);
+}
+
+void TimerWheel::Cascade(int level) {
+    std::uint64_t slot = (m_currentTick >> (LEVEL_BITS * level)) & SLOT_MASK;
+    std::vector<TimerId> ids;
+    ids.swap(m_slots[level][slot]);
+
+    for (TimerId id : ids) {
+        auto it = m_entries.find(id);
+        if (it != m_entries.end()) {
+            Place(id, it->second.expireTick);
+        }
+    }
+}
+
+void TimerWheel::Tick(std::vector<Callback>& expired) {
+    ++m_currentTick;
+
+    // 低层每转完一圈，就把上一层当前槽位中的定时器下放
+    for (int level = 1; level < LEVELS; ++level) {
+        if ((m_currentTick & ((1ull << (LEVEL_BITS * level)) - 1)) != 0) break;
+        Cascade(level);
+    }
+
+    std::vector<TimerId> ids;
+    ids.swap(m_slots[0][m_currentTick & SLOT_MASK]);
+
+    for (TimerId id : ids) {
+        auto it = m_entries.find(id);
+        if (it == m_entries.end()) continue; // 已被取消
+
+        if (it->second.expireTick <= m_currentTick) {
+            expired.push_back(std::move(it->second.callback));
+            m_entries.erase(it);
+        } else {
+            Place(id, it->second.expireTick);
+        }
+    }
+}
+
+} // namespace Game
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Game {
+
+// 分层时间轮 (Hierarchical Timing Wheel)
+// 所有会话的心跳/空闲检测共用这一个时间轮，由 GameServer 的单个 steady_timer 驱动，
+// 避免为每个连接创建一个 steady_timer。Schedule/Cancel 均为 O(1)。
+// 共 LEVELS 层，每层 SLOTS 个槽位：第0层每槽一个 tick，上层每槽覆盖下层一整圈，
+// 当下层转完一圈时，把上层对应槽位中的定时器重新分配 (cascade) 到更低的层。
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId INVALID_TIMER_ID = 0;
+
+    explicit TimerWheel(std::chrono::milliseconds tickInterval);
+
+    // 禁止拷贝和赋值
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // 在 delay 之后触发回调（不会提前，最多延后一个 tick），返回可用于取消的ID
+    TimerId Schedule(std::chrono::milliseconds delay, Callback callback);
+
+    // 取消定时器，已触发或不存在的ID会被忽略
+    void Cancel(TimerId id);
+
+    // 将时间轮推进到 now，执行所有到期的回调
+    // 回调在释放内部锁之后执行，因此回调中可以再次调用 Schedule/Cancel
+    void Advance(Clock::time_point now);
+
+private:
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS = 4;
+    static constexpr std::uint64_t SLOTS = 1ull << LEVEL_BITS;
+    static constexpr std::uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr std::uint64_t MAX_TICKS = (1ull << (LEVEL_BITS * LEVELS)) - 1;
+
+    struct Entry {
+        std::uint64_t expireTick;
+        Callback callback;
+    };
+
+    // 以下函数都需要在持有 m_mutex 的情况下调用
+    void Place(TimerId id, std::uint64_t expireTick);
+    void Cascade(int level);
+    void Tick(std::vector<Callback>& expired);
+
+private:
+    const std::chrono::milliseconds m_tickInterval;
+    const Clock::time_point m_startTime;
+
+    std::mutex m_mutex;
+    std::uint64_t m_currentTick = 0;
+    TimerId m_nextId = INVALID_TIMER_ID + 1;
+    // 槽位只保存ID，定时器本体在 m_entries 中；取消时只需从 m_entries 删除，
+    // 槽位中残留的ID在轮到时被跳过（惰性删除）
+    std::unordered_map<TimerId, Entry> m_entries;
+    std::array<std::array<std::vector<TimerId>, SLOTS>, LEVELS> m_slots;
+};
+
+} // namespace Game